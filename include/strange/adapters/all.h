@@ -4,8 +4,13 @@
 #include "drop.h"
 #include "enumerate.h"
 #include "filter.h"
+#include "memoize.h"
+#include "moving.h"
+#include "route.h"
 #include "take.h"
+#include "tee.h"
 #include "transform.h"
 #include "transform_invoke.h"
+#include "window.h"
 
 #endif
@@ -6,13 +6,13 @@
 namespace strange{
     struct enumerate{
         std::size_t index = 0;
-        void operator()(auto&& yield, strange::begin const& _) noexcept{
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, strange::end const& _) noexcept{
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, auto const&... xs) noexcept{
+        constexpr void operator()(auto&& yield, auto const&... xs) noexcept{
             yield(index++, xs...);
         }
     };
@@ -6,13 +6,13 @@
 namespace strange{
     template<auto f>
     struct filter{
-        void operator()(auto&& yield, strange::begin const& _) noexcept{
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, strange::end const& _) noexcept{
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, auto const&... xs) noexcept{
+        constexpr void operator()(auto&& yield, auto const&... xs) noexcept{
             if(f(xs...)){
                 yield(xs...);
             }
@@ -0,0 +1,116 @@
+#ifndef STRANGE_ADAPTERS_MEMOIZE_HEADER
+#define STRANGE_ADAPTERS_MEMOIZE_HEADER
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+#include "strange/core.h"
+
+namespace strange{
+    namespace detail{
+        // The parameter and return types of a function pointer or of a lambda
+        // with a single, non-template call operator.
+        template<typename T>
+        struct call_signature : call_signature<decltype(&T::operator())>{};
+
+        template<typename R, typename... As>
+        struct call_signature<R(*)(As...)>{
+            using result = std::decay_t<R>;
+            using arguments = std::tuple<std::decay_t<As>...>;
+        };
+        template<typename R, typename... As>
+        struct call_signature<R(*)(As...) noexcept> : call_signature<R(*)(As...)>{};
+        template<typename C, typename R, typename... As>
+        struct call_signature<R(C::*)(As...) const> : call_signature<R(*)(As...)>{};
+        template<typename C, typename R, typename... As>
+        struct call_signature<R(C::*)(As...) const noexcept> : call_signature<R(*)(As...)>{};
+    }
+
+    // Replacement policies for memoize. Each key can live in one of `ways`
+    // slots of its set, and the least recently used of those is evicted.
+    // direct_mapped is the cheapest; set_associative<capacity> is a fully
+    // associative LRU cache, which is only sensible for small capacities.
+    template<std::size_t ways_per_set>
+    struct set_associative{
+        constexpr static std::size_t ways = ways_per_set;
+    };
+    using direct_mapped = set_associative<1>;
+
+    // Like transform<f>, but remembers the results for the most recently seen
+    // arguments. f must take concrete parameter types, which are used as the
+    // cache key, so take std::string rather than std::string_view unless the
+    // viewed data outlives the stream. The cache lives inside the adapter, so
+    // pass it into the pipeline by reference to read the hit and miss counts.
+    template<auto f, std::size_t capacity = 1024, typename policy = direct_mapped>
+    struct memoize{
+        using signature = detail::call_signature<std::remove_cvref_t<decltype(f)>>;
+        using key_t = typename signature::arguments;
+        using value_t = typename signature::result;
+
+        constexpr static std::size_t ways = policy::ways;
+        constexpr static std::size_t sets = capacity / ways;
+        static_assert(ways > 0 && capacity % ways == 0, "The capacity must be a multiple of the number of ways");
+        static_assert(std::has_single_bit(sets), "The number of sets must be a power of two");
+
+        std::array<key_t, capacity> keys{};
+        std::array<value_t, capacity> values{};
+        std::array<std::uint64_t, capacity> last_used{}; // zero for empty slots
+        std::uint64_t clock = 0;
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+        void operator()(auto&& yield, strange::begin const& _) noexcept{
+            yield(_);
+        }
+        void operator()(auto&& yield, strange::end const& _) noexcept{
+            yield(_);
+        }
+        void operator()(auto&& yield, auto const&... xs) noexcept{
+            yield(lookup(key_t(xs...)));
+        }
+
+        value_t const& lookup(key_t&& key) noexcept{
+            ++clock;
+            std::size_t const first = set_of(key) * ways;
+            std::size_t victim = first;
+            for(std::size_t i = first; i < first + ways; ++i){
+                if(last_used[i] != 0 && keys[i] == key){
+                    ++hits;
+                    last_used[i] = clock;
+                    return values[i];
+                }
+                if(last_used[i] < last_used[victim]){
+                    victim = i;
+                }
+            }
+            ++misses;
+            keys[victim] = std::move(key);
+            values[victim] = std::apply(f, keys[victim]);
+            last_used[victim] = clock;
+            return values[victim];
+        }
+
+        private:
+        static std::size_t set_of(key_t const& key) noexcept{
+            if constexpr(sets == 1){
+                return 0;
+            }else{
+                // std::hash is often the identity for integers, so mix the bits
+                // and take the top ones (Fibonacci hashing).
+                constexpr std::uint64_t golden = 0x9e3779b97f4a7c15ull;
+                std::uint64_t const hash = std::apply([](auto const&... parts){
+                    std::uint64_t combined = 0;
+                    ((combined = (combined ^ std::hash<std::decay_t<decltype(parts)>>{}(parts)) * golden), ...);
+                    return combined;
+                }, key);
+                return (hash * golden) >> (64 - std::countr_zero(sets));
+            }
+        }
+    };
+}
+
+#endif
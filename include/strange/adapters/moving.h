@@ -0,0 +1,108 @@
+#ifndef STRANGE_ADAPTERS_MOVING_HEADER
+#define STRANGE_ADAPTERS_MOVING_HEADER
+
+#include <functional>
+#include <type_traits>
+
+#include "strange/core.h"
+#include "strange/adapters/window.h"
+
+namespace strange{
+    // Aggregates over the last N values, updated in constant time per value.
+    // Like window<T, N>, nothing is yielded until the first N values are in.
+
+    // Keeps a running total, so floating point sums can drift over very long
+    // streams.
+    template<typename T, std::size_t N>
+    struct moving_sum{
+        detail::ring<T, N> ring;
+        T sum{};
+
+        constexpr bool add(T const& x) noexcept{
+            if(ring.full()){
+                sum -= ring.oldest();
+            }
+            sum += x;
+            ring.push(x);
+            return ring.full();
+        }
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
+            ring.clear();
+            sum = T{};
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, T const& x) noexcept{
+            if(add(x)){
+                yield(sum);
+            }
+        }
+    };
+
+    // Integer means are yielded as doubles rather than truncated.
+    template<typename T, std::size_t N>
+    struct moving_mean{
+        using mean_t = std::conditional_t<std::is_integral_v<T>, double, T>;
+        moving_sum<T, N> total;
+
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
+            total(yield, _);
+        }
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, T const& x) noexcept{
+            if(total.add(x)){
+                yield(static_cast<mean_t>(total.sum) / static_cast<mean_t>(N));
+            }
+        }
+    };
+
+    // A monotonic deque: values that can never be the extreme of a later
+    // window are discarded as soon as a better one arrives, so the front is
+    // always the answer and each value is pushed and popped at most once.
+    template<typename T, std::size_t N, typename compare_t>
+    struct moving_extreme{
+        struct entry{
+            std::size_t index;
+            T value;
+        };
+        constexpr static std::size_t mask = detail::ring<entry, N>::mask;
+
+        std::array<entry, detail::ring<entry, N>::capacity> entries{};
+        std::size_t front = 0;
+        std::size_t back = 0;
+        std::size_t seen = 0;
+
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
+            front = back = seen = 0;
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, T const& x) noexcept{
+            // expire first, so that there is always room for the new entry
+            if(front != back && entries[front & mask].index + N <= seen){
+                ++front;
+            }
+            while(front != back && !compare_t{}(entries[(back - 1) & mask].value, x)){
+                --back;
+            }
+            entries[back++ & mask] = {seen, x};
+            if(++seen >= N){
+                yield(entries[front & mask].value);
+            }
+        }
+    };
+
+    template<typename T, std::size_t N>
+    using moving_min = moving_extreme<T, N, std::less<>>;
+
+    template<typename T, std::size_t N>
+    using moving_max = moving_extreme<T, N, std::greater<>>;
+}
+
+#endif
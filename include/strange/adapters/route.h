@@ -0,0 +1,126 @@
+#ifndef STRANGE_ADAPTERS_ROUTE_HEADER
+#define STRANGE_ADAPTERS_ROUTE_HEADER
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+#include "strange/core.h"
+
+namespace strange{
+    // One arm of a route: values of type T go to `pipeline`. With a
+    // batch_size above one, values are collected into a block of that many
+    // and handed over together, so the branch's code runs in bursts rather
+    // than interleaved with every other type in the stream.
+    template<typename T, std::size_t batch_size, typename pipeline_t>
+    struct route_branch{
+        using value_t = T;
+        constexpr static bool batched = batch_size > 1;
+
+        pipeline_t pipeline;
+        std::array<T, batched ? batch_size : 0> batch{};
+        std::size_t batched_count = 0;
+
+        constexpr void flush() noexcept{
+            if constexpr(batched){
+                for(std::size_t i = 0; i < batched_count; ++i){
+                    pipeline(batch[i]);
+                }
+                batched_count = 0;
+            }
+        }
+        constexpr void operator()(strange::begin const& _) noexcept{
+            pipeline(_);
+        }
+        constexpr void operator()(strange::end const& _) noexcept{
+            flush();
+            pipeline(_);
+        }
+        constexpr void operator()(T const& x) noexcept{
+            if constexpr(batched){
+                batch[batched_count++] = x;
+                if(batched_count == batch_size){
+                    flush();
+                }
+            }else{
+                pipeline(x);
+            }
+        }
+    };
+
+    template<typename T, std::size_t batch_size = 1, typename pipeline_t>
+    constexpr auto on(pipeline_t&& pipeline) noexcept -> route_branch<T, batch_size, pipeline_t>{
+        return {.pipeline = FWD(pipeline)};
+    }
+
+    // Sends each value to the sub-pipeline registered for its type with on<T>,
+    // chosen at compile time. begin and end go to every branch. Values of
+    // other types, and multiple values yielded together, carry on down the
+    // main pipeline; if there is nothing after the route, every yield must
+    // have a branch.
+    //
+    // Batched branches only see their values in order relative to each other,
+    // not relative to other types, and are flushed when the stream ends.
+    template<typename... branch_ts>
+    struct route{
+        static_assert(sizeof...(branch_ts) > 0, "A route needs at least one branch");
+        std::tuple<branch_ts...> branches;
+
+        constexpr route(branch_ts&&... branches) noexcept
+            : branches{FWD(branches)...}
+        {
+        }
+
+        template<typename T>
+        constexpr static std::size_t branch_index() noexcept{
+            constexpr bool matches[] = {std::is_same_v<typename std::remove_cvref_t<branch_ts>::value_t, T>...};
+            for(std::size_t i = 0; i < sizeof...(branch_ts); ++i){
+                if(matches[i]) return i;
+            }
+            return sizeof...(branch_ts);
+        }
+
+        constexpr void broadcast(auto const& x) noexcept{
+            std::apply([&](auto&... branches){
+                (branches(x), ...);
+            }, branches);
+        }
+        constexpr static void pass_on(auto&& yield, auto const& x) noexcept{
+            if constexpr(!std::is_same_v<std::remove_cvref_t<decltype(yield)>, strange::sink>){
+                yield(x);
+            }
+        }
+
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
+            broadcast(_);
+            pass_on(yield, _);
+        }
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
+            broadcast(_);
+            pass_on(yield, _);
+        }
+        template<typename T>
+        constexpr void operator()(auto&& yield, T const& x) noexcept{
+            constexpr std::size_t index = branch_index<T>();
+            if constexpr(index < sizeof...(branch_ts)){
+                std::get<index>(branches)(x);
+            }else{
+                static_assert(!std::is_same_v<std::remove_cvref_t<decltype(yield)>, strange::sink>,
+                              "This type has no branch in the route, and there's nothing after the route to take it");
+                yield(x);
+            }
+        }
+        // Branches are chosen by the type of a single value, so values yielded
+        // together always carry on down the main pipeline.
+        template<typename T, typename U, typename... Ts>
+        constexpr void operator()(auto&& yield, T const& x, U const& y, Ts const&... xs) noexcept{
+            static_assert(!std::is_same_v<std::remove_cvref_t<decltype(yield)>, strange::sink>,
+                          "route only dispatches single values, and there's nothing after the route to take these");
+            yield(x, y, xs...);
+        }
+    };
+    template<typename... branch_ts>
+    route(branch_ts&&...) -> route<branch_ts...>;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef STRANGE_ADAPTERS_TEE_HEADER
+#define STRANGE_ADAPTERS_TEE_HEADER
+
+#include <tuple>
+
+#include "strange/core.h"
+
+namespace strange{
+    // Feeds everything it receives, begin and end included, to each of a set
+    // of sub-pipelines before passing it on. This lets a single pass over a
+    // source feed several independent computations. If it is the last
+    // component, the stream stops with the sub-pipelines.
+    //
+    // Sub-pipelines passed as lvalues are held by reference, so their results
+    // can be read afterwards; temporaries are moved in.
+    template<typename... pipeline_ts>
+    struct tee{
+        std::tuple<pipeline_ts...> pipelines;
+        constexpr tee(pipeline_ts&&... pipelines) noexcept
+            : pipelines{FWD(pipelines)...}
+        {
+        }
+        constexpr void broadcast(auto const&... xs) noexcept{
+            std::apply([&](auto&... pipelines){
+                (pipelines(xs...), ...);
+            }, pipelines);
+        }
+        constexpr void operator()(strange::sink, auto const&... xs) noexcept{
+            broadcast(xs...);
+        }
+        constexpr void operator()(auto&& yield, auto const&... xs) noexcept{
+            broadcast(xs...);
+            yield(xs...);
+        }
+    };
+    template<typename... pipeline_ts>
+    tee(pipeline_ts&&...) -> tee<pipeline_ts...>;
+}
+
+#endif
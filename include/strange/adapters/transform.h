@@ -6,13 +6,13 @@
 namespace strange{
     template<auto f>
     struct transform{
-        void operator()(auto&& yield, strange::begin const& _) const noexcept{
+        constexpr void operator()(auto&& yield, strange::begin const& _) const noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, strange::end const& _) const noexcept{
+        constexpr void operator()(auto&& yield, strange::end const& _) const noexcept{
             yield(_);
         }
-        void operator()(auto&& yield, auto const&... xs) const noexcept{
+        constexpr void operator()(auto&& yield, auto const&... xs) const noexcept{
             yield(f(xs...));
         }
     };
@@ -0,0 +1,80 @@
+#ifndef STRANGE_ADAPTERS_WINDOW_HEADER
+#define STRANGE_ADAPTERS_WINDOW_HEADER
+
+#include <array>
+#include <bit>
+#include <span>
+
+#include "strange/core.h"
+
+namespace strange{
+    namespace detail{
+        // The last N values pushed, in a power-of-two ring so that wrapping
+        // around is a mask rather than a division.
+        template<typename T, std::size_t N>
+        struct ring{
+            static_assert(N > 0, "A ring must hold at least one value");
+            constexpr static std::size_t capacity = std::bit_ceil(N);
+            constexpr static std::size_t mask = capacity - 1;
+
+            std::array<T, capacity> slots{};
+            std::size_t pushed = 0;
+
+            constexpr void clear() noexcept{
+                pushed = 0;
+            }
+            constexpr bool full() const noexcept{
+                return pushed >= N;
+            }
+            // Only meaningful once the ring is full.
+            constexpr T const& oldest() const noexcept{
+                return slots[(pushed - N) & mask];
+            }
+            constexpr void push(T const& x) noexcept{
+                slots[pushed++ & mask] = x;
+            }
+        };
+    }
+
+    // Yields every `step`th window of the last N values, once N values have
+    // arrived, as a view into its ring buffer rather than a copy. A window
+    // that lies contiguously in the ring is yielded as one std::span<T const>;
+    // one that wraps around the end is yielded as two, oldest values first.
+    // With a step of one most windows wrap, so every downstream stage must
+    // accept both the one-span and the two-span form. Trailing values that
+    // don't complete a window are dropped.
+    template<typename T, std::size_t N, std::size_t step = 1>
+    struct window{
+        static_assert(step > 0, "A window must move forward");
+        detail::ring<T, N> ring;
+
+        constexpr void operator()(auto&& yield, strange::begin const& _) noexcept{
+            ring.clear();
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, strange::end const& _) noexcept{
+            yield(_);
+        }
+        constexpr void operator()(auto&& yield, T const& x) noexcept{
+            ring.push(x);
+            if(!ring.full() || (ring.pushed - N) % step != 0){
+                return;
+            }
+            constexpr std::size_t capacity = detail::ring<T, N>::capacity;
+            std::size_t const first = (ring.pushed - N) & detail::ring<T, N>::mask;
+            T const* const slots = ring.slots.data();
+            if(first + N <= capacity){
+                yield(std::span<T const>{slots + first, N});
+            }else{
+                yield(std::span<T const>{slots + first, capacity - first},
+                      std::span<T const>{slots, N - (capacity - first)});
+            }
+        }
+    };
+
+    // Non-overlapping windows of N values. With N a power of two these never wrap.
+    template<typename T, std::size_t N>
+    using tumbling = window<T, N, N>;
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef STRANGE_API_HEADER
 #define STRANGE_API_HEADER
 
+#include <cstddef>
+#include <string_view>
 #include <utility>
 
 #define FWD(a) std::forward<decltype(a)>(a)
@@ -9,6 +11,20 @@ namespace strange{
     struct begin{};
     struct end{};
 
+    // Lets string literals be used as template arguments, e.g. format_sink<"{}\n">.
+    template<std::size_t N>
+    struct fixed_string{
+        char value[N];
+        constexpr fixed_string(char const (&literal)[N]) noexcept{
+            for(std::size_t i = 0; i < N; ++i){
+                value[i] = literal[i];
+            }
+        }
+        constexpr std::string_view view() const noexcept{
+            return {value, N - 1};
+        }
+    };
+
     struct sink{
         constexpr static bool appendable_pipeline = false;
         constexpr auto operator()(auto... xs) const noexcept{
@@ -1,9 +1,13 @@
 #ifndef STRANGE_SINKS_ALL_HEADER
 #define STRANGE_SINKS_ALL_HEADER
 
+#include "format.h"
 #include "print.h"
 #include "swallow.h"
 #include "file.h"
 #include "to_vector.h"
+#include "to_array.h"
+#include "top_k.h"
+#include "reservoir_sample.h"
 
 #endif
@@ -0,0 +1,95 @@
+#ifndef STRANGE_SINKS_FORMAT_HEADER
+#define STRANGE_SINKS_FORMAT_HEADER
+
+#include <cerrno>
+#include <cstdio>
+#include <iterator>
+
+#include <unistd.h>
+#include <fmt/format.h>
+
+#include "strange/core.h"
+
+namespace strange{
+    // Formats each yield into an in-memory buffer and writes it to the file
+    // descriptor `fd` in blocks of at least `flush_threshold` bytes, and on end.
+    // The format string is checked against the yielded types at compile time.
+    //
+    // When writing to stdout or stderr, the matching stdio stream is flushed
+    // before each block, so anything printed through stdio beforehand comes
+    // out first.
+    //
+    // The buffer is reserved up front, so filling a block doesn't reallocate,
+    // and it is mutable, so a const sink (such as a const print) still works.
+    template<fixed_string format, int fd = 1, std::size_t flush_threshold = (1 << 16)>
+    struct format_sink{
+        mutable fmt::memory_buffer buffer;
+
+        format_sink() noexcept{
+            buffer.reserve(flush_threshold);
+        }
+        // A copy starts empty, as otherwise both would write out the same
+        // unflushed output.
+        format_sink(format_sink const&) noexcept{
+            buffer.reserve(flush_threshold);
+        }
+        format_sink(format_sink&& other) noexcept
+            : buffer{std::move(other.buffer)}
+        {
+        }
+        ~format_sink() noexcept{
+            flush();
+        }
+
+        void flush() const noexcept{
+            if(buffer.size() == 0) return;
+            if constexpr(fd == 1){
+                std::fflush(stdout);
+            }else if constexpr(fd == 2){
+                std::fflush(stderr);
+            }
+            char const* data = buffer.data();
+            std::size_t remaining = buffer.size();
+            while(remaining > 0){
+                auto const written = ::write(fd, data, remaining);
+                if(written < 0){
+                    if(errno == EINTR) continue;
+                    break;
+                }
+                data += written;
+                remaining -= written;
+            }
+            buffer.clear();
+        }
+
+        void append(auto const&... xs) const noexcept{
+            fmt::format_to(std::back_inserter(buffer),
+                           fmt::format_string<decltype(xs)...>{format.view()},
+                           xs...);
+            if(buffer.size() >= flush_threshold){
+                flush();
+            }
+        }
+
+        void operator()(strange::sink, strange::begin) const noexcept{}
+        void operator()(strange::sink, strange::end) const noexcept{
+            flush();
+        }
+        void operator()(strange::sink, auto const&... xs) const noexcept{
+            append(xs...);
+        }
+        void operator()(auto&& yield, strange::begin x) const noexcept{
+            yield(x);
+        }
+        void operator()(auto&& yield, strange::end x) const noexcept{
+            flush();
+            yield(x);
+        }
+        void operator()(auto&& yield, auto const&... xs) const noexcept{
+            append(xs...);
+            yield(xs...);
+        }
+    };
+}
+
+#endif
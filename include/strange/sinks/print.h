@@ -1,27 +1,12 @@
 #ifndef STRANGE_SINKS_PRINT_HEADER
 #define STRANGE_SINKS_PRINT_HEADER
 
-#include <fmt/format.h>
 #include "strange/core.h"
+#include "strange/sinks/format.h"
 
 namespace strange{
-    struct print{
-        void operator()(strange::sink, strange::begin) const noexcept{}
-        void operator()(strange::sink, strange::end) const noexcept{}
-        void operator()(strange::sink, auto&& value) const noexcept{
-            fmt::print("- {}\n", value);
-        }
-        void operator()(auto&& yield, strange::begin x) const noexcept{
-            yield(x);
-        }
-        void operator()(auto&& yield, strange::end x) const noexcept{
-            yield(x);
-        }
-        void operator()(auto&& yield, auto&& value) const noexcept{
-            fmt::print("- {}\n", value);
-            yield(value);
-        }
-    };
+    // Prints each value to stdout as a bullet point.
+    struct print : format_sink<"- {}\n">{};
 }
 
 #endif
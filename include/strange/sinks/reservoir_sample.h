@@ -0,0 +1,151 @@
+#ifndef STRANGE_SINKS_RESERVOIR_SAMPLE_HEADER
+#define STRANGE_SINKS_RESERVOIR_SAMPLE_HEADER
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "strange/core.h"
+
+namespace strange{
+    namespace detail{
+        // splitmix64: tiny state, fast, and plenty good enough for sampling.
+        struct splitmix64{
+            std::uint64_t state;
+
+            constexpr std::uint64_t next() noexcept{
+                std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+            // Uniform in (0, 1), never exactly zero, so it is always safe to log.
+            constexpr double uniform() noexcept{
+                return (static_cast<double>(next() >> 11) + 0.5) * 0x1.0p-53;
+            }
+            // Uniform in [0, n), near enough for any n a stream will reach.
+            constexpr std::uint64_t below(std::uint64_t n) noexcept{
+                return std::min(static_cast<std::uint64_t>(uniform() * static_cast<double>(n)), n - 1);
+            }
+            double normal() noexcept{
+                return std::sqrt(-2.0 * std::log(uniform())) * std::cos(6.283185307179586 * uniform());
+            }
+            // Marsaglia and Tsang's method, for shape >= 1.
+            double gamma(double shape) noexcept{
+                double const d = shape - 1.0 / 3.0;
+                double const c = 1.0 / std::sqrt(9.0 * d);
+                while(true){
+                    double const x = normal();
+                    double v = 1.0 + c * x;
+                    if(v <= 0) continue;
+                    v = v * v * v;
+                    if(std::log(uniform()) < 0.5 * x * x + d - d * v + d * std::log(v)){
+                        return d * v;
+                    }
+                }
+            }
+        };
+    }
+
+    // A uniform random sample of K values from a stream of unknown length,
+    // using Li's Algorithm L: rather than drawing a random number per value,
+    // it draws how many values to skip before the next one that gets in, so
+    // it needs O(K log(n/K)) random numbers for n values and the common path
+    // is a single comparison.
+    //
+    // The sample lives in the sink, so pass it into the pipeline by reference.
+    // Samples taken on different threads (with different seeds!) can be
+    // combined with merge(), and the merged sample can keep on streaming.
+    template<typename T, std::size_t K>
+    struct reservoir_sample{
+        static_assert(K > 0, "reservoir_sample needs room for at least one value");
+
+        std::array<T, K> reservoir{};
+        std::uint64_t seen = 0;
+        std::uint64_t next = 0; // the index of the next value to be let in, once full
+        double w = 0;
+        detail::splitmix64 random;
+
+        constexpr explicit reservoir_sample(std::uint64_t seed = 0x5eed5eed5eed5eedull) noexcept
+            : random{seed}
+        {
+        }
+
+        constexpr std::span<T const> values() const noexcept{
+            return {reservoir.data(), static_cast<std::size_t>(std::min<std::uint64_t>(seen, K))};
+        }
+
+        void operator()(strange::sink, strange::begin) noexcept{}
+        void operator()(strange::sink, strange::end) noexcept{}
+        void operator()(strange::sink, T const& value) noexcept{
+            if(seen < K){
+                reservoir[seen++] = value;
+                if(seen == K){
+                    w = std::exp(std::log(random.uniform()) / K);
+                    skip();
+                }
+                return;
+            }
+            if(seen++ == next){
+                reservoir[random.below(K)] = value;
+                w *= std::exp(std::log(random.uniform()) / K);
+                skip();
+            }
+        }
+
+        // Replaces this sample with a uniform sample of both streams. The
+        // number taken from each side is hypergeometric, as it would be had
+        // one sampler seen both streams.
+        void merge(reservoir_sample const& other) noexcept{
+            std::uint64_t const total = seen + other.seen;
+            std::size_t const take = std::min<std::uint64_t>(total, K);
+            std::uint64_t mine_left = seen;
+            std::uint64_t theirs_left = other.seen;
+            std::size_t from_mine = 0;
+            for(std::size_t i = 0; i < take; ++i){
+                if(random.below(mine_left + theirs_left) < mine_left){
+                    ++from_mine;
+                    --mine_left;
+                }else{
+                    --theirs_left;
+                }
+            }
+
+            std::array<T, K> theirs = other.reservoir;
+            choose_front(reservoir, values().size(), from_mine);
+            choose_front(theirs, other.values().size(), take - from_mine);
+            std::copy_n(theirs.begin(), take - from_mine, reservoir.begin() + from_mine);
+            seen = total;
+
+            if(seen >= K){
+                // Carry on as though one sampler had seen everything: w is the
+                // largest of the K smallest of `seen` uniform keys.
+                double const kept = random.gamma(K);
+                double const rest = random.gamma(static_cast<double>(seen - K + 1));
+                w = kept / (kept + rest);
+                skip();
+            }
+        }
+
+        private:
+        void skip() noexcept{
+            double const gap = std::floor(std::log(random.uniform()) / std::log1p(-w));
+            if(gap >= static_cast<double>(std::numeric_limits<std::uint64_t>::max() - seen)){
+                next = std::numeric_limits<std::uint64_t>::max();
+            }else{
+                next = seen + static_cast<std::uint64_t>(gap);
+            }
+        }
+        // Moves a uniformly chosen `count` of the first `size` values to the front.
+        void choose_front(std::array<T, K>& pool, std::size_t size, std::size_t count) noexcept{
+            for(std::size_t i = 0; i < count; ++i){
+                std::swap(pool[i], pool[i + random.below(size - i)]);
+            }
+        }
+    };
+}
+
+#endif
@@ -3,7 +3,7 @@
 
 namespace strange{
     struct swallow{
-        void operator()(strange::sink, auto&&...){}
+        constexpr void operator()(strange::sink, auto&&...) noexcept{}
     };
 }
 
@@ -0,0 +1,50 @@
+#ifndef STRANGE_SINKS_TO_ARRAY_HEADER
+#define STRANGE_SINKS_TO_ARRAY_HEADER
+
+#include <array>
+
+#include "strange/core.h"
+#include "strange/pipeline.h"
+
+namespace strange{
+    // Fills a fixed-size array. Usable in constant expressions, which makes
+    // it the way to turn a pipeline into a compile-time table. Values beyond
+    // the end of the array are counted but not stored.
+    template<typename T, std::size_t N>
+    struct to_array{
+        std::array<T, N>& result;
+        std::size_t count = 0;
+
+        constexpr void operator()(strange::sink, strange::begin) noexcept{}
+        constexpr void operator()(strange::sink, strange::end) noexcept{}
+        constexpr void operator()(strange::sink, T const& value) noexcept{
+            if(count < N){
+                result[count] = value;
+            }
+            ++count;
+        }
+    };
+
+    namespace detail{
+        // Deliberately not constexpr (nor defined): reaching this during
+        // constant evaluation makes the build fail with this name in the error.
+        void evaluated_wrong_number_of_values() noexcept;
+    }
+
+    // Runs a pipeline that is missing its sink at compile time, returning
+    // exactly the N values it yields as an array. Yielding any other number
+    // of values is a compile error. For a runtime table, use to_array.
+    template<typename T, std::size_t N, typename... component_ts>
+    consteval std::array<T, N> evaluate(pipeline<component_ts...>&& unfinished) noexcept{
+        std::array<T, N> result{};
+        to_array<T, N> sink{result};
+        auto finished = std::move(unfinished) | sink;
+        finished();
+        if(sink.count != N){
+            detail::evaluated_wrong_number_of_values();
+        }
+        return result;
+    }
+}
+
+#endif
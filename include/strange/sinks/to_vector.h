@@ -10,9 +10,9 @@ namespace strange{
     struct to_vector{
         std::vector<T>& result;
 
-        void operator()(strange::sink, strange::begin) noexcept{}
-        void operator()(strange::sink, strange::end) noexcept{}
-        void operator()(strange::sink, T const& value) noexcept{
+        constexpr void operator()(strange::sink, strange::begin) noexcept{}
+        constexpr void operator()(strange::sink, strange::end) noexcept{}
+        constexpr void operator()(strange::sink, T const& value) noexcept{
             result.push_back(value);
         }
     };
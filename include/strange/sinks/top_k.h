@@ -0,0 +1,125 @@
+#ifndef STRANGE_SINKS_TOP_K_HEADER
+#define STRANGE_SINKS_TOP_K_HEADER
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "strange/core.h"
+
+namespace strange{
+    // Keeps the K values with the highest score_fn(value) in a fixed-size
+    // min-heap. Once the heap is full, the lowest kept score is cached, so
+    // most values are turned away with a single comparison.
+    //
+    // With an arithmetic score and a small, trivially copyable value type, scores are
+    // computed for a batch of values at a time and the whole batch is tested
+    // against the threshold in one loop that the compiler can vectorise; only
+    // batches with a contender touch the heap. Batches are flushed on end.
+    //
+    // Results live in the sink, so pass it into the pipeline by reference.
+    // Sinks filled on different threads can be combined with merge().
+    template<typename T, std::size_t K, auto score_fn>
+    struct top_k{
+        static_assert(K > 0, "top_k needs room for at least one value");
+        using score_t = std::decay_t<decltype(score_fn(std::declval<T const&>()))>;
+        struct entry{
+            score_t score;
+            T value;
+        };
+        // Batching copies every value, so it only pays for values no bigger than a couple of scores.
+        constexpr static bool batched = std::is_arithmetic_v<score_t>
+                                     && std::is_trivially_copyable_v<T>
+                                     && sizeof(T) <= 2 * sizeof(score_t);
+        constexpr static std::size_t batch_size = batched ? 32 : 0;
+
+        std::array<entry, K> heap{};
+        std::size_t size = 0;
+        score_t threshold{}; // the lowest score in the heap, once it is full
+
+        std::array<score_t, batch_size> pending_scores{};
+        std::array<T, batch_size> pending_values{};
+        std::size_t pending = 0;
+
+        constexpr static bool lower_score(entry const& a, entry const& b) noexcept{
+            // reversed, so that the std heap functions keep the lowest score at the front
+            return a.score > b.score;
+        }
+
+        constexpr void offer(score_t const& s, T const& value) noexcept{
+            if(size < K){
+                heap[size++] = {s, value};
+                std::push_heap(heap.begin(), heap.begin() + size, lower_score);
+            }else{
+                if(!(s > threshold)) return;
+                std::pop_heap(heap.begin(), heap.end(), lower_score);
+                heap.back() = {s, value};
+                std::push_heap(heap.begin(), heap.end(), lower_score);
+            }
+            if(size == K){
+                threshold = heap.front().score;
+            }
+        }
+
+        constexpr void flush() noexcept{
+            if constexpr(batched){
+                if(size == K){
+                    bool contender = false;
+                    for(std::size_t i = 0; i < pending; ++i){
+                        contender |= pending_scores[i] > threshold;
+                    }
+                    if(!contender){
+                        pending = 0;
+                        return;
+                    }
+                }
+                for(std::size_t i = 0; i < pending; ++i){
+                    offer(pending_scores[i], pending_values[i]);
+                }
+                pending = 0;
+            }
+        }
+
+        constexpr void merge(top_k const& other) noexcept{
+            flush();
+            for(std::size_t i = 0; i < other.size; ++i){
+                offer(other.heap[i].score, other.heap[i].value);
+            }
+            for(std::size_t i = 0; i < other.pending; ++i){
+                offer(other.pending_scores[i], other.pending_values[i]);
+            }
+        }
+
+        // The kept values, highest score first. Values still waiting in a
+        // batch are only included once end or flush() has been called.
+        std::vector<T> sorted() const{
+            std::array<entry, K> ordered = heap;
+            std::sort(ordered.begin(), ordered.begin() + size, lower_score);
+            std::vector<T> result;
+            result.reserve(size);
+            for(std::size_t i = 0; i < size; ++i){
+                result.push_back(ordered[i].value);
+            }
+            return result;
+        }
+
+        constexpr void operator()(strange::sink, strange::begin) noexcept{}
+        constexpr void operator()(strange::sink, strange::end) noexcept{
+            flush();
+        }
+        constexpr void operator()(strange::sink, T const& value) noexcept{
+            if constexpr(batched){
+                pending_scores[pending] = score_fn(value);
+                pending_values[pending] = value;
+                if(++pending == batch_size){
+                    flush();
+                }
+            }else{
+                offer(score_fn(value), value);
+            }
+        }
+    };
+}
+
+#endif
@@ -4,5 +4,6 @@
 #include "each.h"
 #include "range.h"
 #include "file.h"
+#include "async_file.h"
 
 #endif
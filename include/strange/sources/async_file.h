@@ -0,0 +1,432 @@
+#ifndef STRANGE_SOURCES_ASYNC_TEXTFILE_HEADER
+#define STRANGE_SOURCES_ASYNC_TEXTFILE_HEADER
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STRANGE_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "strange/core.h"
+
+namespace strange{
+    namespace detail{
+        // Reads until the buffer is full, the file runs out or a read fails. A
+        // result shorter than the requested length means end of file, unless
+        // `error` has been set to the errno of the failed read.
+        inline std::size_t pread_fully(int fd, char* buffer, std::size_t length, off_t offset, int& error) noexcept{
+            std::size_t total = 0;
+            while(total < length){
+                auto got = ::pread(fd, buffer + total, length - total, offset + total);
+                if(got > 0){
+                    total += got;
+                }else if(got == 0){
+                    break;
+                }else if(errno != EINTR){
+                    error = errno;
+                    break;
+                }
+            }
+            return total;
+        }
+
+        // Fallback read-ahead: a background thread fills the slots in order,
+        // staying up to `depth` blocks ahead of the consumer.
+        template<std::size_t block_size, std::size_t depth>
+        struct threaded_reads{
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::array<bool, depth> filled{};
+            std::array<std::size_t, depth> sizes{};
+            bool stopping = false;
+            int error = 0;
+            std::thread worker;
+
+            bool start(int fd, off_t offset, char* buffers) noexcept{
+                worker = std::thread([this, fd, offset, buffers]{
+                    for(std::size_t block = 0;; ++block){
+                        std::size_t const slot = block % depth;
+                        {
+                            std::unique_lock lock{mutex};
+                            changed.wait(lock, [&]{ return stopping || !filled[slot]; });
+                            if(stopping) return;
+                        }
+                        int failure = 0;
+                        auto const size = pread_fully(fd, buffers + slot * (block_size + 1), block_size,
+                                                      offset + block * block_size, failure);
+                        {
+                            std::lock_guard lock{mutex};
+                            sizes[slot] = size;
+                            filled[slot] = true;
+                            error = failure;
+                        }
+                        changed.notify_all();
+                        if(size < block_size) return;
+                    }
+                });
+                return true;
+            }
+            std::size_t wait(std::size_t slot) noexcept{
+                std::unique_lock lock{mutex};
+                changed.wait(lock, [&]{ return filled[slot]; });
+                return sizes[slot];
+            }
+            void release(std::size_t slot) noexcept{
+                {
+                    std::lock_guard lock{mutex};
+                    filled[slot] = false;
+                }
+                changed.notify_all();
+            }
+            ~threaded_reads() noexcept{
+                {
+                    std::lock_guard lock{mutex};
+                    stopping = true;
+                }
+                changed.notify_all();
+                if(worker.joinable()){
+                    worker.join();
+                }
+            }
+        };
+
+#ifdef STRANGE_HAS_IO_URING
+        // Preferred read-ahead: every slot has a read in flight in the kernel,
+        // talking to io_uring directly so that liburing isn't a dependency.
+        // start() fails if the kernel (or a seccomp policy) refuses a ring.
+        template<std::size_t block_size, std::size_t depth>
+        struct io_uring_reads{
+            int ring_fd = -1;
+            int fd = -1;
+            char* buffers = nullptr;
+            void* sq_ring = MAP_FAILED;
+            void* cq_ring = MAP_FAILED;
+            std::size_t sq_ring_size = 0;
+            std::size_t cq_ring_size = 0;
+            io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+            std::size_t sqes_size = 0;
+            unsigned* sq_tail;
+            unsigned* sq_mask;
+            unsigned* sq_array;
+            unsigned* cq_head;
+            unsigned* cq_tail;
+            unsigned* cq_mask;
+            io_uring_cqe* cqes;
+
+            std::array<iovec, depth> requests{};
+            std::array<off_t, depth> offsets{};
+            std::array<std::size_t, depth> sizes{};
+            std::array<bool, depth> in_flight{};
+            int error = 0;
+
+            bool start(int file, off_t offset, char* slot_buffers) noexcept{
+                io_uring_params params{};
+                ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &params));
+                if(ring_fd < 0) return false;
+
+                sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                bool const single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                if(single_mmap){
+                    sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+                }
+                sq_ring = ::mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 ring_fd, IORING_OFF_SQ_RING);
+                if(sq_ring == MAP_FAILED) return false;
+                cq_ring = single_mmap ? sq_ring
+                                      : ::mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+                if(cq_ring == MAP_FAILED) return false;
+                sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+                sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                                                         MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES));
+                if(sqes == MAP_FAILED) return false;
+
+                auto const sq = static_cast<char*>(sq_ring);
+                auto const cq = static_cast<char*>(cq_ring);
+                sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+                fd = file;
+                buffers = slot_buffers;
+                for(std::size_t slot = 0; slot < depth; ++slot){
+                    offsets[slot] = offset + slot * block_size;
+                    sizes[slot] = 0;
+                    if(!enqueue(slot)) return false;
+                }
+                return true;
+            }
+            std::size_t wait(std::size_t slot) noexcept{
+                while(in_flight[slot]){
+                    reap();
+                }
+                return sizes[slot];
+            }
+            void release(std::size_t slot) noexcept{
+                offsets[slot] += depth * block_size;
+                sizes[slot] = 0;
+                submit(slot);
+            }
+            ~io_uring_reads() noexcept{
+                // The kernel may still be writing into our buffers.
+                if(sqes != MAP_FAILED){
+                    for(std::size_t slot = 0; slot < depth; ++slot){
+                        while(in_flight[slot]) reap();
+                    }
+                }
+                if(sqes != MAP_FAILED) ::munmap(sqes, sqes_size);
+                if(cq_ring != MAP_FAILED && cq_ring != sq_ring) ::munmap(cq_ring, cq_ring_size);
+                if(sq_ring != MAP_FAILED) ::munmap(sq_ring, sq_ring_size);
+                if(ring_fd >= 0) ::close(ring_fd);
+            }
+
+            private:
+            // Queues a read of the rest of the slot. If the kernel won't take it
+            // (EAGAIN, ENOMEM, ...) the entry is taken back off the queue, or the
+            // next successful enter would submit it in place of its own.
+            bool enqueue(std::size_t slot) noexcept{
+                requests[slot] = {
+                    .iov_base = buffers + slot * (block_size + 1) + sizes[slot],
+                    .iov_len = block_size - sizes[slot]
+                };
+                unsigned const tail = *sq_tail;
+                unsigned const index = tail & *sq_mask;
+                io_uring_sqe& sqe = sqes[index];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<std::uintptr_t>(&requests[slot]);
+                sqe.len = 1;
+                sqe.off = offsets[slot] + sizes[slot];
+                sqe.user_data = slot;
+                sq_array[index] = index;
+                std::atomic_ref<unsigned>{*sq_tail}.store(tail + 1, std::memory_order_release);
+                while(::syscall(__NR_io_uring_enter, ring_fd, 1, 0, 0, nullptr, 0) < 0){
+                    if(errno != EINTR){
+                        std::atomic_ref<unsigned>{*sq_tail}.store(tail, std::memory_order_release);
+                        return false;
+                    }
+                }
+                in_flight[slot] = true;
+                return true;
+            }
+            // Keeps the slot filling: through the ring if it will have it, and
+            // otherwise by reading the rest of the slot here and now.
+            void submit(std::size_t slot) noexcept{
+                if(!enqueue(slot)){
+                    sizes[slot] += pread_fully(fd, buffers + slot * (block_size + 1) + sizes[slot],
+                                               block_size - sizes[slot], offsets[slot] + sizes[slot], error);
+                }
+            }
+            void reap() noexcept{
+                unsigned const head = *cq_head;
+                if(head == std::atomic_ref<unsigned>{*cq_tail}.load(std::memory_order_acquire)){
+                    ::syscall(__NR_io_uring_enter, ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    return;
+                }
+                io_uring_cqe const& cqe = cqes[head & *cq_mask];
+                auto const slot = static_cast<std::size_t>(cqe.user_data);
+                int const result = cqe.res;
+                std::atomic_ref<unsigned>{*cq_head}.store(head + 1, std::memory_order_release);
+
+                in_flight[slot] = false;
+                if(result == -EINTR || result == -EAGAIN){
+                    submit(slot);
+                }else if(result < 0){
+                    // the slot stays short, which ends the stream, and error says why
+                    error = -result;
+                }else if(result > 0){
+                    sizes[slot] += result;
+                    // short reads happen on network filesystems; only a zero read is end of file
+                    if(sizes[slot] < block_size){
+                        submit(slot);
+                    }
+                }
+            }
+        };
+#endif
+    }
+
+    // An alternative to text_file_reader that keeps `depth` reads of
+    // `block_size` bytes in flight while the pipeline works through the
+    // current block, so that disk and CPU overlap. Lines are split exactly
+    // as text_file_reader (i.e. fgets) would split them, but are always
+    // yielded as char const*, without copying unless they straddle two
+    // blocks. Records split on any `delimiter`.
+    //
+    // If a read fails the stream ends early, without the partial record that
+    // was being read, and `error` holds the errno. It is reset on each pass.
+    template<std::size_t line_length,
+             std::size_t block_size = (1 << 20),
+             std::size_t depth = 2,
+             char delimiter = '\n'>
+    struct async_text_file_reader{
+        static_assert(line_length > 1, "A line must have room for at least one character");
+        static_assert(depth > 0, "At least one read must be in flight");
+
+        constexpr static std::size_t stride = block_size + 1;
+
+        int handle;
+        off_t start_offset;
+        std::unique_ptr<char[]> buffers;
+        bool prefer_io_uring = true;
+        mutable int error = 0;
+        private:
+        async_text_file_reader(int handle, off_t start_offset, std::unique_ptr<char[]> buffers) noexcept
+            : handle{handle}
+            , start_offset{start_offset}
+            , buffers{std::move(buffers)}
+        {
+        }
+
+        // Each record is terminated in place, so the byte after it is borrowed
+        // for the duration of the yield. The extra byte per slot covers the last one.
+        static void yield_in_place(auto&& yield, char* first, char* last) noexcept{
+            char const borrowed = *last;
+            *last = '\0';
+            yield(static_cast<char const*>(first));
+            *last = borrowed;
+        }
+
+        static void split(auto&& yield, char* first, char* last, char* carry, std::size_t& carried) noexcept{
+            constexpr std::size_t chunk = line_length - 1;
+            if(carried > 0){
+                std::size_t const room = std::min<std::size_t>(chunk - carried, last - first);
+                auto const found = static_cast<char*>(std::memchr(first, delimiter, room));
+                std::size_t const taken = found ? found + 1 - first : room;
+                std::memcpy(carry + carried, first, taken);
+                carried += taken;
+                first += taken;
+                if(!found && carried < chunk) return;
+                carry[carried] = '\0';
+                yield(static_cast<char const*>(carry));
+                carried = 0;
+            }
+            while(first < last){
+                std::size_t const room = std::min<std::size_t>(chunk, last - first);
+                auto const found = static_cast<char*>(std::memchr(first, delimiter, room));
+                if(!found && room < chunk) break;
+                char* const record_end = found ? found + 1 : first + chunk;
+                yield_in_place(yield, first, record_end);
+                first = record_end;
+            }
+            std::memcpy(carry, first, last - first);
+            carried = last - first;
+        }
+
+        void flush(auto&& yield, auto& reads) const noexcept{
+            char carry[line_length];
+            std::size_t carried = 0;
+            for(std::size_t slot = 0;; slot = (slot + 1) % depth){
+                char* const data = buffers.get() + slot * stride;
+                std::size_t const size = reads.wait(slot);
+                split(yield, data, data + size, carry, carried);
+                if(size < block_size) break;
+                reads.release(slot);
+            }
+            error = reads.error;
+            if(carried > 0 && error == 0){
+                carry[carried] = '\0';
+                yield(static_cast<char const*>(carry));
+            }
+        }
+
+        public:
+        async_text_file_reader(async_text_file_reader&& other) noexcept
+            : handle{other.handle}
+            , start_offset{other.start_offset}
+            , buffers{std::move(other.buffers)}
+            , prefer_io_uring{other.prefer_io_uring}
+            , error{other.error}
+        {
+            other.handle = -1;
+        }
+        ~async_text_file_reader() noexcept{
+            if(handle >= 0){
+                ::close(handle);
+            }
+        }
+
+        void operator()(auto&& yield) const noexcept{
+            yield(strange::begin{});
+#ifdef STRANGE_HAS_IO_URING
+            if(prefer_io_uring){
+                detail::io_uring_reads<block_size, depth> reads;
+                if(reads.start(handle, start_offset, buffers.get())){
+                    flush(yield, reads);
+                    yield(strange::end{});
+                    return;
+                }
+            }
+#endif
+            detail::threaded_reads<block_size, depth> reads;
+            reads.start(handle, start_offset, buffers.get());
+            flush(yield, reads);
+            yield(strange::end{});
+        }
+
+        static std::optional<async_text_file_reader> try_open(char const* path, bool skip_header = false) noexcept{
+            int handle = ::open(path, O_RDONLY | O_CLOEXEC);
+            if(handle < 0){
+                return std::nullopt;
+            }
+            std::unique_ptr<char[]> buffers{new(std::nothrow) char[depth * stride]};
+            if(!buffers){
+                ::close(handle);
+                return std::nullopt;
+            }
+            off_t start_offset = 0;
+            if(skip_header){
+                char scratch[4096];
+                int error = 0;
+                while(true){
+                    auto const got = detail::pread_fully(handle, scratch, sizeof(scratch), start_offset, error);
+                    if(error != 0){
+                        ::close(handle);
+                        return std::nullopt;
+                    }
+                    auto const found = static_cast<char*>(std::memchr(scratch, '\n', got));
+                    if(found){
+                        start_offset += found + 1 - scratch;
+                        break;
+                    }
+                    start_offset += got;
+                    if(got < sizeof(scratch)) break;
+                }
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(handle, start_offset, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            return async_text_file_reader{handle, start_offset, std::move(buffers)};
+        }
+        static std::optional<async_text_file_reader> try_open(std::filesystem::path const& path, bool skip_header = false) noexcept{
+            return try_open(path.c_str(), skip_header);
+        }
+    };
+}
+
+#endif
@@ -7,7 +7,7 @@ namespace strange{
     template<typename... Ts>
     struct each{
         std::tuple<Ts...> ts;
-        each(Ts... ts) noexcept
+        constexpr each(Ts... ts) noexcept
             : ts{ts...}
         {
         }
@@ -0,0 +1,180 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+#include "allocations.h"
+
+// Replacing the global allocation functions is only allowed once per program,
+// so this is the one translation unit that does it. Everything else just reads
+// the counters via allocations.h.
+
+namespace{
+    thread_local strange_test::allocation_stats this_thread_allocations{};
+
+    void* counted_allocate(std::size_t size){
+        ++this_thread_allocations.allocations;
+        this_thread_allocations.bytes += size;
+        if(void* p = std::malloc(size ? size : 1)){
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+    void* counted_allocate(std::size_t size, std::align_val_t alignment){
+        ++this_thread_allocations.allocations;
+        this_thread_allocations.bytes += size;
+        auto const align = static_cast<std::size_t>(alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        if(void* p = std::aligned_alloc(align, (size + align - 1) / align * align)){
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+    void counted_deallocate(void* p) noexcept{
+        if(p){
+            ++this_thread_allocations.deallocations;
+            std::free(p);
+        }
+    }
+}
+
+strange_test::allocation_stats strange_test::thread_allocations() noexcept{
+    return this_thread_allocations;
+}
+
+void* operator new(std::size_t size){ return counted_allocate(size); }
+void* operator new[](std::size_t size){ return counted_allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment){ return counted_allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment){ return counted_allocate(size, alignment); }
+void operator delete(void* p) noexcept{ counted_deallocate(p); }
+void operator delete[](void* p) noexcept{ counted_deallocate(p); }
+void operator delete(void* p, std::size_t) noexcept{ counted_deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept{ counted_deallocate(p); }
+void operator delete(void* p, std::align_val_t) noexcept{ counted_deallocate(p); }
+void operator delete[](void* p, std::align_val_t) noexcept{ counted_deallocate(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept{ counted_deallocate(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept{ counted_deallocate(p); }
+
+namespace{
+    struct Fizz{};
+    struct Buzz{};
+}
+
+TEST_CASE("Allocation counter sees allocations"){
+    // the vector outlives the lambda and is checked afterwards, so the
+    // compiler can't elide its allocations
+    std::vector<int> v;
+    auto const stats = strange_test::count_allocations([&]{
+        v.resize(100);
+        v.push_back(1);
+    });
+    REQUIRE(v.size() == 101);
+    REQUIRE(v.back() == 1);
+    // the initial buffer, then a bigger one to grow into, freeing the first
+    REQUIRE(stats.allocations == 2);
+    REQUIRE(stats.deallocations == 1);
+    REQUIRE(stats.bytes >= 101 * sizeof(int));
+}
+
+TEST_CASE("Sources and adapters do not allocate"){
+    REQUIRE_NO_ALLOCATIONS(
+        auto pipeline = strange::builder{}
+                      | strange::range{1ull, 100'000ull}
+                      | strange::filter<[](auto x){ return x % 3 == 0; }>{}
+                      | strange::transform<[](auto x){ return x * 2; }>{}
+                      | strange::swallow{};
+        pipeline();
+    );
+    REQUIRE_NO_ALLOCATIONS(
+        auto pipeline = strange::builder{}
+                      | strange::unrolled_range<1, 1'000>{}
+                      | strange::drop<10>{}
+                      | strange::take<100>{}
+                      | strange::enumerate{}
+                      | strange::swallow{};
+        pipeline();
+    );
+    REQUIRE_NO_ALLOCATIONS(
+        auto pipeline = strange::builder{}
+                      | strange::each{1, 3.14159265, "Hello, world"}
+                      | strange::transform_invoke<[](auto&& yield, auto const& x){
+                            yield(x);
+                            yield(x);
+                        }>{}
+                      | strange::swallow{};
+        pipeline();
+    );
+    REQUIRE_NO_ALLOCATIONS(
+        auto pipeline = strange::builder{}
+                      | strange::range{1, 1'000}
+                      | strange::transform_invoke<[](auto&& yield, int i){
+                            if(i % 3 == 0){
+                                yield(Fizz{});
+                            }else if(i % 5 == 0){
+                                yield(Buzz{});
+                            }else{
+                                yield(i);
+                            }
+                        }>{}
+                      | strange::swallow{};
+        pipeline();
+    );
+}
+
+TEST_CASE("Text file reader does not allocate"){
+    auto path = std::filesystem::temp_directory_path() / "strange_allocations_test.txt";
+    {
+        FILE* handle = fopen(path.c_str(), "w");
+        REQUIRE(handle != nullptr);
+        for(int i = 0; i < 1000; ++i){
+            fprintf(handle, "line %d\n", i);
+        }
+        fclose(handle);
+    }
+    auto maybe_reader = strange::text_file_reader<64>::try_open(path);
+    REQUIRE(maybe_reader.has_value());
+    // Only operator new is counted: the FILE's own buffer comes from malloc,
+    // inside fopen and the first fgets, so this checks the reader itself.
+    REQUIRE_NO_ALLOCATIONS(
+        auto pipeline = strange::builder{}
+                      | maybe_reader.value()
+                      | strange::swallow{};
+        pipeline();
+    );
+}
+
+TEST_CASE("Format sink fills a block without reallocating"){
+    strange::format_sink<"{}\n", 2, 4096> sink{};
+    // the buffer is reserved up front, so a block's worth of lines fits in it
+    REQUIRE_NO_ALLOCATIONS(
+        for(int i = 0; i < 400; ++i){
+            sink.append(i);
+        }
+    );
+    REQUIRE(sink.buffer.size() > 1000);
+    sink.buffer.clear();
+}
+
+TEST_CASE("Allocations are attributed to the stage that made them"){
+    strange_test::allocation_stats source_stats{}, transform_stats{}, sink_stats{};
+    std::vector<std::string> result;
+    auto pipeline = strange::builder{}
+                  | strange_test::counted{strange::range{1, 100}, source_stats}
+                  | strange_test::counted{strange::transform<[](int i){ return std::string(i, 'x'); }>{}, transform_stats}
+                  | strange_test::counted{strange::to_vector{result}, sink_stats};
+    pipeline();
+
+    REQUIRE(result.size() == 99);
+    REQUIRE(source_stats.allocations == 0);
+    // every string above the small string optimisation size is on the heap
+    REQUIRE(transform_stats.allocations > 0);
+    REQUIRE(transform_stats.deallocations == transform_stats.allocations);
+    // the vector growing, and a copy of each long string
+    REQUIRE(sink_stats.allocations > transform_stats.allocations);
+}
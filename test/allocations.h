@@ -0,0 +1,106 @@
+#ifndef STRANGE_TEST_ALLOCATIONS_HEADER
+#define STRANGE_TEST_ALLOCATIONS_HEADER
+
+/* Allocation accounting for tests.
+ *
+ * allocations.cpp replaces the global operator new and delete for the test
+ * executable so that every allocation made through them on a thread is
+ * tallied in that thread's allocation_stats. Tests can then check that a
+ * pipeline run allocates nothing, and wrap individual components in `counted`
+ * to find out which stage is responsible when it does.
+ *
+ * Calls straight to malloc, such as stdio's buffers or C libraries, are not
+ * seen.
+ * */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/core.h>
+
+namespace strange_test{
+    struct allocation_stats{
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytes = 0;
+
+        constexpr allocation_stats& operator+=(allocation_stats const& other) noexcept{
+            allocations += other.allocations;
+            deallocations += other.deallocations;
+            bytes += other.bytes;
+            return *this;
+        }
+        constexpr allocation_stats& operator-=(allocation_stats const& other) noexcept{
+            allocations -= other.allocations;
+            deallocations -= other.deallocations;
+            bytes -= other.bytes;
+            return *this;
+        }
+        constexpr friend allocation_stats operator-(allocation_stats a, allocation_stats const& b) noexcept{
+            return a -= b;
+        }
+    };
+
+    // Running totals for the calling thread, since the start of the thread.
+    allocation_stats thread_allocations() noexcept;
+
+    // The allocations made on this thread while invoking f.
+    allocation_stats count_allocations(auto&& f) noexcept{
+        auto const before = thread_allocations();
+        f();
+        return thread_allocations() - before;
+    }
+
+    // Forwards to the rest of the pipeline, keeping a tally of what the rest
+    // of the pipeline allocated so that it isn't blamed on the current stage.
+    template<typename yield_t>
+    struct excluding_yield{
+        yield_t& yield;
+        allocation_stats& downstream;
+        void operator()(auto&&... xs) noexcept{
+            downstream += count_allocations([&]{ yield(FWD(xs)...); });
+        }
+    };
+
+    template<typename yield_t>
+    using stage_yield_t = std::conditional_t<
+        std::is_same_v<std::remove_cvref_t<yield_t>, strange::sink>,
+        strange::sink,
+        excluding_yield<std::remove_reference_t<yield_t>>
+    >;
+
+    // Wraps a pipeline component, accumulating into `stats` the allocations
+    // made by that component alone across every invocation.
+    template<typename component_t>
+    struct counted{
+        component_t component;
+        allocation_stats& stats;
+
+        template<typename yield_t, typename... xs_t>
+            requires std::is_invocable_v<component_t&, stage_yield_t<yield_t>, xs_t...>
+        void operator()(yield_t&& yield, xs_t&&... xs) noexcept{
+            allocation_stats downstream{};
+            auto const total = count_allocations([&]{
+                if constexpr(std::is_same_v<stage_yield_t<yield_t>, strange::sink>){
+                    component(strange::sink{}, FWD(xs)...);
+                }else{
+                    component(excluding_yield<std::remove_reference_t<yield_t>>{yield, downstream}, FWD(xs)...);
+                }
+            });
+            stats += total - downstream;
+        }
+    };
+    template<typename component_t>
+    counted(component_t, allocation_stats&) -> counted<component_t>;
+}
+
+#define REQUIRE_NO_ALLOCATIONS(...)                                                         \
+    do{                                                                                     \
+        auto const strange_allocations_ = ::strange_test::count_allocations([&]{ __VA_ARGS__; }); \
+        REQUIRE(strange_allocations_.allocations == 0);                                     \
+        REQUIRE(strange_allocations_.bytes == 0);                                           \
+    }while(false)
+
+#endif
@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+namespace{
+    // Lines of varying length, some longer than the line length used below,
+    // and no trailing newline so that the final partial line is exercised.
+    std::filesystem::path write_test_file(){
+        auto path = std::filesystem::temp_directory_path() / "strange_async_file_test.txt";
+        FILE* handle = fopen(path.c_str(), "w");
+        REQUIRE(handle != nullptr);
+        fputs("header line\n", handle);
+        for(int i = 0; i < 2000; ++i){
+            fprintf(handle, "line %d %s\n", i, std::string(i % 97, 'x').c_str());
+        }
+        fputs("no newline at the end", handle);
+        fclose(handle);
+        return path;
+    }
+
+    template<std::size_t line_length>
+    std::vector<std::string> read_with_fgets(std::filesystem::path const& path, bool skip_header = false){
+        auto maybe_reader = strange::text_file_reader<line_length>::try_open(path, skip_header);
+        REQUIRE(maybe_reader.has_value());
+        std::vector<std::string> lines;
+        auto pipeline = strange::builder{}
+                      | maybe_reader.value()
+                      | strange::to_vector{lines};
+        pipeline();
+        return lines;
+    }
+
+    template<typename reader_t>
+    std::vector<std::string> read_async(std::filesystem::path const& path, bool prefer_io_uring, bool skip_header = false){
+        auto maybe_reader = reader_t::try_open(path, skip_header);
+        REQUIRE(maybe_reader.has_value());
+        maybe_reader->prefer_io_uring = prefer_io_uring;
+        std::vector<std::string> lines;
+        auto pipeline = strange::builder{}
+                      | maybe_reader.value()
+                      | strange::to_vector{lines};
+        pipeline();
+        return lines;
+    }
+}
+
+TEST_CASE("Async text file reader matches text_file_reader"){
+    auto path = write_test_file();
+    auto const expected = read_with_fgets<64>(path);
+    REQUIRE(expected.size() > 2000);
+
+    for(bool prefer_io_uring : {true, false}){
+        // blocks much smaller than lines, blocks much larger than lines, and the default
+        REQUIRE(read_async<strange::async_text_file_reader<64, 16, 3>>(path, prefer_io_uring) == expected);
+        REQUIRE(read_async<strange::async_text_file_reader<64, 4096, 2>>(path, prefer_io_uring) == expected);
+        REQUIRE(read_async<strange::async_text_file_reader<64>>(path, prefer_io_uring) == expected);
+    }
+}
+
+TEST_CASE("Async text file reader skips headers"){
+    auto path = write_test_file();
+    auto const expected = read_with_fgets<256>(path, true);
+    REQUIRE(expected.front() == "line 0 \n");
+    for(bool prefer_io_uring : {true, false}){
+        REQUIRE(read_async<strange::async_text_file_reader<256, 100, 4>>(path, prefer_io_uring, true) == expected);
+    }
+}
+
+TEST_CASE("Async text file reader can be invoked repeatedly"){
+    auto path = write_test_file();
+    auto maybe_reader = strange::async_text_file_reader<256, 512>::try_open(path);
+    REQUIRE(maybe_reader.has_value());
+    std::vector<std::string> lines;
+    auto pipeline = strange::builder{}
+                  | maybe_reader.value()
+                  | strange::to_vector{lines};
+    pipeline();
+    auto const first_pass = lines.size();
+    pipeline();
+    REQUIRE(lines.size() == 2 * first_pass);
+}
+
+TEST_CASE("Async text file reader yields one type"){
+    auto path = write_test_file();
+    auto const expected = read_with_fgets<64>(path);
+    for(bool prefer_io_uring : {true, false}){
+        // the last line has no newline, so it is carried out of the final block
+        auto maybe_reader = strange::async_text_file_reader<64, 16, 3>::try_open(path);
+        REQUIRE(maybe_reader.has_value());
+        maybe_reader->prefer_io_uring = prefer_io_uring;
+        std::vector<std::string> lines;
+        auto pipeline = strange::builder{}
+                      | maybe_reader.value()
+                      | strange::transform_invoke<[](auto&& yield, auto const& line){
+                            static_assert(std::is_same_v<std::decay_t<decltype(line)>, char const*>);
+                            yield(line);
+                        }>{}
+                      | strange::to_vector{lines};
+        pipeline();
+        REQUIRE(maybe_reader->error == 0);
+        REQUIRE(lines == expected);
+    }
+}
+
+TEST_CASE("Async text file reader reports read errors"){
+    // a directory opens, but reading it fails with EISDIR
+    auto maybe_reader = strange::async_text_file_reader<64, 16, 3>::try_open(std::filesystem::temp_directory_path());
+    REQUIRE(maybe_reader.has_value());
+    for(bool prefer_io_uring : {true, false}){
+        maybe_reader->prefer_io_uring = prefer_io_uring;
+        std::vector<std::string> lines;
+        auto pipeline = strange::builder{}
+                      | maybe_reader.value()
+                      | strange::to_vector{lines};
+        pipeline();
+        REQUIRE(lines.empty());
+        REQUIRE(maybe_reader->error == EISDIR);
+    }
+}
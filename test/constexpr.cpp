@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <array>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+// Everything here is checked with static_assert, so it's the compiler that
+// runs the pipelines. The REQUIREs only check the same tables again at runtime.
+
+constexpr auto squares = strange::evaluate<int, 10>(
+    strange::builder{}
+    | strange::range{0, 10}
+    | strange::transform<[](int i){ return i * i; }>{}
+);
+static_assert(squares == std::array{0, 1, 4, 9, 16, 25, 36, 49, 64, 81});
+
+constexpr auto odd_cubes = strange::evaluate<uint64_t, 5>(
+    strange::builder{}
+    | strange::unrolled_range<uint64_t{0}, uint64_t{100}>{}
+    | strange::filter<[](uint64_t i){ return i % 2 == 1; }>{}
+    | strange::drop<2>{}
+    | strange::take<5>{}
+    | strange::transform<[](uint64_t i){ return i * i * i; }>{}
+);
+static_assert(odd_cubes == std::array<uint64_t, 5>{125, 343, 729, 1331, 2197});
+
+constexpr auto indexed = strange::evaluate<std::size_t, 3>(
+    strange::builder{}
+    | strange::each{10, 20, 30}
+    | strange::enumerate{}
+    | strange::transform_invoke<[](auto&& yield, std::size_t i, int x){
+          yield(i * 1000 + x);
+      }>{}
+);
+static_assert(indexed == std::array<std::size_t, 3>{10, 1020, 2030});
+
+constexpr auto partial_table = []{
+    std::array<int, 8> table{};
+    strange::to_array<int, 8> sink{table};
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 100}
+                  | strange::filter<[](int i){ return i % 7 == 0; }>{}
+                  | sink;
+    pipeline();
+    return std::pair{table, sink.count};
+}();
+static_assert(partial_table.first.back() == 49);
+static_assert(partial_table.second == 15);
+
+TEST_CASE("Compile time tables"){
+    REQUIRE(squares[9] == 81);
+    REQUIRE(odd_cubes[0] == 125);
+    REQUIRE(indexed[2] == 2030);
+    REQUIRE(partial_table.second == 15);
+}
+
+TEST_CASE("to_array at runtime"){
+    std::array<int, 4> table{};
+    strange::to_array<int, 4> sink{table};
+    auto pipeline = strange::builder{}
+                  | strange::range{1, 4}
+                  | sink;
+    pipeline();
+    REQUIRE(sink.count == 3);
+    REQUIRE(table == std::array{1, 2, 3, 0});
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+// format_sink takes its file descriptor as a template argument, so the tests
+// point a fixed descriptor at a temporary file for the duration of each test.
+constexpr int test_fd = 117;
+
+struct redirected_fd{
+    std::filesystem::path path;
+    redirected_fd(char const* name)
+        : path{std::filesystem::temp_directory_path() / name}
+    {
+        int handle = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(handle >= 0);
+        REQUIRE(::dup2(handle, test_fd) == test_fd);
+        ::close(handle);
+    }
+    ~redirected_fd(){
+        ::close(test_fd);
+    }
+    std::string contents() const{
+        std::ifstream file{path};
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+};
+
+TEST_CASE("Format sink writes everything by the end of the stream"){
+    redirected_fd output{"strange_format_test.txt"};
+    auto pipeline = strange::builder{}
+                  | strange::range{1, 4}
+                  | strange::format_sink<"value {}\n", test_fd>{};
+    pipeline();
+    REQUIRE(output.contents() == "value 1\nvalue 2\nvalue 3\n");
+}
+
+TEST_CASE("Format sink handles multiple arguments and passes them on"){
+    redirected_fd output{"strange_format_test.txt"};
+    auto pipeline = strange::builder{}
+                  | strange::each{"a", "b"}
+                  | strange::enumerate{}
+                  | strange::format_sink<"{}={}\n", test_fd>{}
+                  | strange::transform_invoke<[](auto&& yield, std::size_t i, char const*){
+                        yield(i);
+                    }>{}
+                  | strange::format_sink<"[{:>3}]", test_fd>{};
+    pipeline();
+    // the inner sink flushes on end before passing it on to the outer sink
+    REQUIRE(output.contents() == "0=a\n1=b\n[  0][  1]");
+}
+
+TEST_CASE("Format sink flushes in blocks"){
+    redirected_fd output{"strange_format_test.txt"};
+    strange::format_sink<"{}\n", test_fd, 64> sink{};
+    for(int i = 0; i < 10; ++i){
+        sink(strange::sink{}, 1'000'000);
+    }
+    // eight bytes per line, so the first flush happens after eight lines
+    REQUIRE(output.contents().size() == 64);
+    sink(strange::sink{}, strange::end{});
+    REQUIRE(output.contents().size() == 80);
+}
+
+TEST_CASE("Format sink can be used through a const reference"){
+    redirected_fd output{"strange_format_test.txt"};
+    {
+        strange::format_sink<"{} ", test_fd> const sink{};
+        auto pipeline = strange::builder{}
+                      | strange::range{1, 4}
+                      | sink;
+        pipeline();
+    }
+    REQUIRE(output.contents() == "1 2 3 ");
+}
+
+TEST_CASE("Format sink copies start empty"){
+    redirected_fd output{"strange_format_test.txt"};
+    {
+        strange::format_sink<"{}", test_fd> original{};
+        original(strange::sink{}, 7);
+        auto copy = original;
+        REQUIRE(copy.buffer.size() == 0);
+    }
+    REQUIRE(output.contents() == "7");
+}
+
+TEST_CASE("Print keeps its place among stdio output"){
+    auto path = std::filesystem::temp_directory_path() / "strange_print_test.txt";
+    std::fflush(stdout);
+    int const saved_stdout = ::dup(1);
+    {
+        int handle = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(handle >= 0);
+        ::dup2(handle, 1);
+        ::close(handle);
+    }
+    std::printf("header\n");
+    auto pipeline = strange::builder{}
+                  | strange::range{1, 3}
+                  | strange::print{};
+    pipeline();
+    std::printf("footer\n");
+    std::fflush(stdout);
+    ::dup2(saved_stdout, 1);
+    ::close(saved_stdout);
+
+    std::ifstream file{path};
+    std::stringstream stream;
+    stream << file.rdbuf();
+    REQUIRE(stream.str() == "header\n- 1\n- 2\nfooter\n");
+}
@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+namespace{
+    std::size_t square_calls = 0;
+    uint64_t counted_square(uint64_t x){
+        ++square_calls;
+        return x * x;
+    }
+}
+
+TEST_CASE("Memoize yields the same as transform"){
+    std::vector<uint64_t> expected, memoized;
+    auto transform_pipeline = strange::builder{}
+                            | strange::range{0ull, 10'000ull}
+                            | strange::transform<[](uint64_t x){ return (x % 37) * (x % 37); }>{}
+                            | strange::to_vector{expected};
+    transform_pipeline();
+
+    square_calls = 0;
+    strange::memoize<[](uint64_t x){ return counted_square(x); }, 64> cache{};
+    auto memoize_pipeline = strange::builder{}
+                          | strange::range{0ull, 10'000ull}
+                          | strange::transform<[](uint64_t x){ return x % 37; }>{}
+                          | cache
+                          | strange::to_vector{memoized};
+    memoize_pipeline();
+
+    REQUIRE(memoized == expected);
+    REQUIRE(cache.hits + cache.misses == 10'000);
+    REQUIRE(cache.misses == square_calls);
+    REQUIRE(cache.misses < 1'000);
+}
+
+TEST_CASE("Set associative memoize evicts the least recently used key"){
+    square_calls = 0;
+    // a single set of four ways, i.e. a four element LRU cache
+    strange::memoize<counted_square, 4, strange::set_associative<4>> cache{};
+    auto pipeline = strange::builder{}
+                  | strange::each{1ull, 2ull, 3ull, 4ull, 1ull, 5ull, 1ull, 2ull}
+                  | cache
+                  | strange::swallow{};
+    pipeline();
+    // 5 evicts 2, which was used least recently, so only 1 is ever a hit
+    REQUIRE(cache.hits == 2);
+    REQUIRE(cache.misses == 6);
+    REQUIRE(square_calls == 6);
+}
+
+TEST_CASE("Direct mapped memoize never keeps two keys in the same slot"){
+    strange::memoize<counted_square, 1> cache{};
+    auto pipeline = strange::builder{}
+                  | strange::each{1ull, 2ull, 1ull, 1ull, 2ull}
+                  | cache
+                  | strange::swallow{};
+    pipeline();
+    REQUIRE(cache.hits == 1);
+    REQUIRE(cache.misses == 4);
+}
+
+TEST_CASE("Memoize keys on every argument"){
+    std::vector<std::string> result;
+    strange::memoize<[](std::size_t i, std::string const& word){
+        return word + std::to_string(i % 2);
+    }, 16> cache{};
+    auto pipeline = strange::builder{}
+                  | strange::each{"a", "b", "a", "b", "a"}
+                  | strange::enumerate{}
+                  | strange::transform_invoke<[](auto&& yield, std::size_t i, char const* word){
+                        yield(i % 2, word);
+                    }>{}
+                  | cache
+                  | strange::to_vector{result};
+    pipeline();
+    REQUIRE(result == std::vector<std::string>{"a0", "b1", "a0", "b1", "a0"});
+    REQUIRE(cache.misses == 2);
+    REQUIRE(cache.hits == 3);
+}
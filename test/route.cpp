@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+namespace{
+    struct Fizz{};
+    struct Buzz{};
+    struct FizzBuzz{};
+
+    template<typename T>
+    struct tally{
+        std::size_t begins = 0;
+        std::size_t ends = 0;
+        std::size_t count = 0;
+        void operator()(strange::sink, strange::begin) noexcept{
+            ++begins;
+        }
+        void operator()(strange::sink, strange::end) noexcept{
+            ++ends;
+        }
+        void operator()(strange::sink, T const&) noexcept{
+            ++count;
+        }
+    };
+
+    constexpr auto fizzbuzz = [](auto&& yield, uint64_t const& i){
+        bool const divides_3 = i % 3 == 0;
+        bool const divides_5 = i % 5 == 0;
+        if(divides_3 && divides_5){
+            yield(FizzBuzz{});
+        }else if(divides_3){
+            yield(Fizz{});
+        }else if(divides_5){
+            yield(Buzz{});
+        }else{
+            yield(i);
+        }
+    };
+}
+
+TEST_CASE("Route sends each type to its own branch"){
+    tally<Fizz> fizzes{};
+    tally<Buzz> buzzes{};
+    tally<FizzBuzz> fizzbuzzes{};
+    std::vector<uint64_t> numbers;
+    auto pipeline = strange::builder{}
+                  | strange::range{1ull, 101ull}
+                  | strange::transform_invoke<fizzbuzz>{}
+                  | strange::route(
+                        strange::on<Fizz>(strange::builder{} | fizzes),
+                        strange::on<Buzz>(strange::builder{} | buzzes),
+                        strange::on<FizzBuzz>(strange::builder{} | fizzbuzzes),
+                        strange::on<uint64_t>(strange::builder{} | strange::to_vector{numbers})
+                    );
+    pipeline();
+
+    REQUIRE(fizzes.count == 27);
+    REQUIRE(buzzes.count == 14);
+    REQUIRE(fizzbuzzes.count == 6);
+    REQUIRE(numbers.size() == 53);
+    REQUIRE(numbers.front() == 1);
+    REQUIRE(numbers.back() == 98);
+    REQUIRE(fizzes.begins == 1);
+    REQUIRE(fizzes.ends == 1);
+    REQUIRE(fizzbuzzes.begins == 1);
+    REQUIRE(fizzbuzzes.ends == 1);
+}
+
+TEST_CASE("Route passes unrouted types down the pipeline"){
+    tally<Fizz> fizzes{};
+    tally<Buzz> buzzes{};
+    std::vector<uint64_t> numbers;
+    auto pipeline = strange::builder{}
+                  | strange::range{1ull, 101ull}
+                  | strange::transform_invoke<fizzbuzz>{}
+                  | strange::route(
+                        strange::on<Fizz>(strange::builder{} | fizzes),
+                        strange::on<FizzBuzz>(strange::builder{} | strange::swallow{})
+                    )
+                  | strange::route(
+                        strange::on<Buzz>(strange::builder{} | buzzes)
+                    )
+                  | strange::to_vector{numbers};
+    pipeline();
+
+    REQUIRE(fizzes.count == 27);
+    REQUIRE(buzzes.count == 14);
+    REQUIRE(numbers.size() == 53);
+}
+
+TEST_CASE("Batched routes keep per-type order and flush at the end"){
+    std::vector<uint64_t> evens, odds;
+    auto pipeline = strange::builder{}
+                  | strange::range{0ull, 1'000ull}
+                  | strange::transform_invoke<[](auto&& yield, uint64_t const& i){
+                        if(i % 2 == 0){
+                            yield(i);
+                        }else{
+                            yield(static_cast<int>(i));
+                        }
+                    }>{}
+                  | strange::route(
+                        strange::on<uint64_t, 64>(strange::builder{} | strange::to_vector{evens}),
+                        strange::on<int, 7>(strange::builder{}
+                                            | strange::transform<[](int i){ return static_cast<uint64_t>(i); }>{}
+                                            | strange::to_vector{odds})
+                    );
+    pipeline();
+
+    REQUIRE(evens.size() == 500);
+    REQUIRE(odds.size() == 500);
+    for(std::size_t i = 0; i < 500; ++i){
+        REQUIRE(evens[i] == 2 * i);
+        REQUIRE(odds[i] == 2 * i + 1);
+    }
+}
+
+TEST_CASE("Route passes multi-value yields down the pipeline"){
+    tally<int> ints{};
+    std::vector<std::size_t> indices;
+    auto pipeline = strange::builder{}
+                  | strange::each{10, 20, 30}
+                  | strange::enumerate{}
+                  | strange::route(
+                        strange::on<int>(strange::builder{} | ints)
+                    )
+                  | strange::transform_invoke<[](auto&& yield, std::size_t i, int){
+                        yield(i);
+                    }>{}
+                  | strange::to_vector{indices};
+    pipeline();
+    REQUIRE(ints.count == 0);
+    REQUIRE(ints.begins == 1);
+    REQUIRE(indices == std::vector<std::size_t>{0, 1, 2});
+}
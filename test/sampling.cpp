@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+// Deterministic values that jump around, so the top k aren't simply the last k.
+constexpr uint64_t scramble(uint64_t i){
+    return (i * 0x9e3779b97f4a7c15ull) >> 40;
+}
+
+TEST_CASE("Top k keeps the highest scores"){
+    strange::top_k<uint64_t, 10, [](uint64_t x){ return scramble(x); }> best{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0ull, 100'000ull}
+                  | best;
+    pipeline();
+
+    std::vector<uint64_t> expected(100'000);
+    for(uint64_t i = 0; i < expected.size(); ++i){
+        expected[i] = i;
+    }
+    std::sort(expected.begin(), expected.end(), [](uint64_t a, uint64_t b){ return scramble(a) > scramble(b); });
+    expected.resize(10);
+    REQUIRE(best.sorted() == expected);
+}
+
+TEST_CASE("Top k with fewer values than k, and non-arithmetic values"){
+    strange::top_k<std::string, 5, [](std::string const& s){ return s.size(); }> longest{};
+    auto pipeline = strange::builder{}
+                  | strange::each{"a", "abc", "ab"}
+                  | strange::transform<[](char const* s){ return std::string(s); }>{}
+                  | longest;
+    pipeline();
+    REQUIRE(longest.sorted() == std::vector<std::string>{"abc", "ab", "a"});
+}
+
+namespace{
+    struct record{
+        uint64_t id;
+        std::array<char, 120> payload;
+    };
+}
+
+TEST_CASE("Top k only batches small values"){
+    using small = strange::top_k<uint64_t, 4, [](uint64_t x){ return scramble(x); }>;
+    using large = strange::top_k<record, 4, [](record const& r){ return scramble(r.id); }>;
+    static_assert(small::batched);
+    static_assert(!large::batched);
+
+    large best{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0ull, 1'000ull}
+                  | strange::transform<[](uint64_t i){ return record{i, {}}; }>{}
+                  | best;
+    pipeline();
+    strange::top_k<uint64_t, 4, [](uint64_t x){ return scramble(x); }> expected{};
+    auto expected_pipeline = strange::builder{} | strange::range{0ull, 1'000ull} | expected;
+    expected_pipeline();
+    std::vector<uint64_t> ids;
+    for(auto const& r : best.sorted()){
+        ids.push_back(r.id);
+    }
+    REQUIRE(ids == expected.sorted());
+}
+
+TEST_CASE("Top k merges"){
+    strange::top_k<uint64_t, 8, [](uint64_t x){ return scramble(x); }> all{}, first{}, second{};
+    auto all_pipeline = strange::builder{} | strange::range{0ull, 10'000ull} | all;
+    auto first_pipeline = strange::builder{} | strange::range{0ull, 4'000ull} | first;
+    auto second_pipeline = strange::builder{} | strange::range{4'000ull, 10'000ull} | second;
+    all_pipeline();
+    first_pipeline();
+    second_pipeline();
+    first.merge(second);
+    REQUIRE(first.sorted() == all.sorted());
+}
+
+TEST_CASE("Reservoir sample keeps everything from a short stream"){
+    strange::reservoir_sample<int, 10> sample{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 4}
+                  | sample;
+    pipeline();
+    REQUIRE(std::vector<int>(sample.values().begin(), sample.values().end()) == std::vector<int>{0, 1, 2, 3});
+}
+
+// Each of 100 values should turn up in a sample of 10 about a tenth of the time.
+void check_uniform(std::array<std::size_t, 100> const& counts, std::size_t trials){
+    for(auto count : counts){
+        REQUIRE(count > trials / 10 * 7 / 10);
+        REQUIRE(count < trials / 10 * 13 / 10);
+    }
+}
+
+TEST_CASE("Reservoir sample is uniform"){
+    constexpr std::size_t trials = 4'000;
+    std::array<std::size_t, 100> counts{};
+    for(std::size_t trial = 0; trial < trials; ++trial){
+        strange::reservoir_sample<int, 10> sample{trial + 1};
+        auto pipeline = strange::builder{}
+                      | strange::range{0, 100}
+                      | sample;
+        pipeline();
+        REQUIRE(sample.values().size() == 10);
+        for(int x : sample.values()){
+            ++counts[x];
+        }
+    }
+    check_uniform(counts, trials);
+}
+
+TEST_CASE("Merged reservoir samples are uniform and keep streaming"){
+    constexpr std::size_t trials = 4'000;
+    std::array<std::size_t, 100> counts{};
+    for(std::size_t trial = 0; trial < trials; ++trial){
+        strange::reservoir_sample<int, 10> first{2 * trial + 1}, second{2 * trial + 2};
+        auto first_pipeline = strange::builder{} | strange::range{0, 30} | first;
+        auto second_pipeline = strange::builder{} | strange::range{30, 70} | second;
+        first_pipeline();
+        second_pipeline();
+        first.merge(second);
+        auto rest = strange::builder{} | strange::range{70, 100} | first;
+        rest();
+        REQUIRE(first.values().size() == 10);
+        std::vector<int> values(first.values().begin(), first.values().end());
+        std::sort(values.begin(), values.end());
+        REQUIRE(std::adjacent_find(values.begin(), values.end()) == values.end());
+        for(int x : values){
+            ++counts[x];
+        }
+    }
+    check_uniform(counts, trials);
+}
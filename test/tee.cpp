@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+struct summer{
+    std::size_t begins = 0;
+    std::size_t ends = 0;
+    uint64_t total = 0;
+    void operator()(strange::sink, strange::begin) noexcept{
+        ++begins;
+    }
+    void operator()(strange::sink, strange::end) noexcept{
+        ++ends;
+    }
+    void operator()(strange::sink, uint64_t const& x) noexcept{
+        total += x;
+    }
+};
+
+// Counts what comes out of the source, to check that it is only read once.
+struct source_counter{
+    std::size_t begins = 0;
+    std::size_t values = 0;
+    void operator()(auto&& yield, strange::begin const& _) noexcept{
+        ++begins;
+        yield(_);
+    }
+    void operator()(auto&& yield, strange::end const& _) noexcept{
+        yield(_);
+    }
+    void operator()(auto&& yield, uint64_t const& x) noexcept{
+        ++values;
+        yield(x);
+    }
+};
+
+TEST_CASE("Tee feeds every sub-pipeline in one pass"){
+    summer all{}, evens{};
+    std::vector<uint64_t> squares;
+    source_counter source{};
+    auto pipeline = strange::builder{}
+                  | strange::range{1ull, 101ull}
+                  | source
+                  | strange::tee{
+                        strange::builder{} | all,
+                        strange::builder{} | strange::filter<[](uint64_t x){ return x % 2 == 0; }>{} | evens,
+                        strange::builder{} | strange::take<5>{}
+                                           | strange::transform<[](uint64_t x){ return x * x; }>{}
+                                           | strange::to_vector{squares}
+                    }
+                  | strange::transform_invoke<[](auto&& yield, auto const& x){ yield(x); }>{}
+                  | strange::tee{
+                        strange::builder{} | strange::swallow{}
+                    };
+    pipeline();
+
+    REQUIRE(source.begins == 1);
+    REQUIRE(source.values == 100);
+    REQUIRE(all.total == 5050);
+    REQUIRE(all.begins == 1);
+    REQUIRE(all.ends == 1);
+    REQUIRE(evens.total == 2550);
+    REQUIRE(evens.begins == 1);
+    REQUIRE(evens.ends == 1);
+    REQUIRE(squares == std::vector<uint64_t>{1, 4, 9, 16, 25});
+}
+
+TEST_CASE("Tee continues the main pipeline"){
+    summer side{}, main{};
+    auto pipeline = strange::builder{}
+                  | strange::range{1ull, 11ull}
+                  | strange::tee{strange::builder{} | side}
+                  | strange::filter<[](uint64_t x){ return (x > 5); }>{}
+                  | main;
+    pipeline();
+    REQUIRE(side.total == 55);
+    REQUIRE(main.total == 40);
+    REQUIRE(main.begins == 1);
+    REQUIRE(main.ends == 1);
+}
@@ -0,0 +1,132 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <strange/strange.h>
+
+// Flattens each window, whether it arrives in one piece or two, into a vector.
+struct window_collector{
+    std::vector<std::vector<int>> windows;
+    std::size_t split_windows = 0;
+    void operator()(strange::sink, strange::begin) noexcept{}
+    void operator()(strange::sink, strange::end) noexcept{}
+    void operator()(strange::sink, std::span<int const> whole){
+        windows.emplace_back(whole.begin(), whole.end());
+    }
+    void operator()(strange::sink, std::span<int const> older, std::span<int const> newer){
+        ++split_windows;
+        auto& window = windows.emplace_back(older.begin(), older.end());
+        window.insert(window.end(), newer.begin(), newer.end());
+    }
+};
+
+// Deterministic values in [-500, 500) that jump around enough to exercise min and max.
+constexpr int noise(int i){
+    return static_cast<int>((static_cast<uint32_t>(i) * 2654435761u) >> 16) % 1000 - 500;
+}
+
+std::vector<int> test_values(){
+    std::vector<int> values;
+    for(int i = 0; i < 500; ++i){
+        values.push_back(noise(i));
+    }
+    return values;
+}
+
+template<std::size_t N, std::size_t step>
+std::vector<std::vector<int>> expected_windows(std::vector<int> const& values){
+    std::vector<std::vector<int>> windows;
+    for(std::size_t end = N; end <= values.size(); end += step){
+        windows.emplace_back(values.begin() + (end - N), values.begin() + end);
+    }
+    return windows;
+}
+
+template<std::size_t N, std::size_t step>
+void check_window(){
+    auto const values = test_values();
+    window_collector collector{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 500}
+                  | strange::transform<noise>{}
+                  | strange::window<int, N, step>{}
+                  | collector;
+    pipeline();
+    REQUIRE(collector.windows == expected_windows<N, step>(values));
+}
+
+TEST_CASE("Sliding windows"){
+    check_window<1, 1>();
+    check_window<3, 1>();
+    check_window<4, 1>();
+    check_window<5, 2>();
+    check_window<16, 7>();
+}
+
+TEST_CASE("Windows that wrap around the ring arrive in two parts"){
+    window_collector collector{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 10}
+                  | strange::window<int, 3>{}
+                  | collector;
+    pipeline();
+    REQUIRE(collector.windows.size() == 8);
+    REQUIRE(collector.split_windows > 0);
+    REQUIRE(collector.windows[5] == std::vector<int>{5, 6, 7});
+}
+
+TEST_CASE("Tumbling windows"){
+    window_collector collector{};
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 10}
+                  | strange::tumbling<int, 4>{}
+                  | collector;
+    pipeline();
+    REQUIRE(collector.split_windows == 0);
+    REQUIRE(collector.windows == std::vector<std::vector<int>>{{0, 1, 2, 3}, {4, 5, 6, 7}});
+}
+
+TEST_CASE("Moving aggregates match brute force"){
+    auto const values = test_values();
+    constexpr std::size_t N = 7;
+    std::vector<int> sums, mins, maxes;
+    std::vector<double> means;
+    auto pipeline = strange::builder{}
+                  | strange::range{0, 500}
+                  | strange::transform<noise>{}
+                  | strange::tee{
+                        strange::builder{} | strange::moving_sum<int, N>{} | strange::to_vector{sums},
+                        strange::builder{} | strange::moving_mean<int, N>{} | strange::to_vector{means},
+                        strange::builder{} | strange::moving_min<int, N>{} | strange::to_vector{mins},
+                        strange::builder{} | strange::moving_max<int, N>{} | strange::to_vector{maxes}
+                    };
+    pipeline();
+
+    auto const windows = expected_windows<N, 1>(values);
+    REQUIRE(sums.size() == windows.size());
+    REQUIRE(means.size() == windows.size());
+    REQUIRE(mins.size() == windows.size());
+    REQUIRE(maxes.size() == windows.size());
+    for(std::size_t i = 0; i < windows.size(); ++i){
+        int const sum = std::accumulate(windows[i].begin(), windows[i].end(), 0);
+        REQUIRE(sums[i] == sum);
+        REQUIRE(means[i] == static_cast<double>(sum) / N);
+        REQUIRE(mins[i] == *std::min_element(windows[i].begin(), windows[i].end()));
+        REQUIRE(maxes[i] == *std::max_element(windows[i].begin(), windows[i].end()));
+    }
+}
+
+TEST_CASE("Moving minimum of a decreasing then increasing sequence"){
+    std::vector<int> mins;
+    auto pipeline = strange::builder{}
+                  | strange::each{5, 4, 3, 2, 1, 2, 3, 4, 5}
+                  | strange::moving_min<int, 3>{}
+                  | strange::to_vector{mins};
+    pipeline();
+    REQUIRE(mins == std::vector<int>{3, 2, 1, 1, 1, 2, 3});
+}